@@ -0,0 +1,1101 @@
+// Python extension exposing the C++ engines with the same API as graph_coloring.py
+//
+//   python setup.py build_ext --inplace
+//   from graph_coloring_native import Graph, FrequencyAssigner, NetworkGenerator
+//
+// A Graph keeps a CSR snapshot plus a color array indexed like the snapshot.
+// `ids`, `colors`, `degrees` and `positions` are zero-copy NumPy views of those
+// arrays. While any view is alive the topology cannot change (BufferError), the
+// same rule bytearray uses for resizing. Graph.from_edges ingests NumPy edge
+// arrays through the buffer protocol. Engines run with the GIL released.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <structmember.h>
+
+#define GRAPH_COLORING_NO_MAIN
+#include "graph_coloring.cpp"
+
+// Topology is edited through a mutable Graph and snapshotted on demand; graphs
+// built in bulk start as a snapshot and only get a builder when edited
+struct NativeGraph {
+    unique_ptr<Graph> builder;
+    CompactGraph snapshot;
+    vector<int> colors;
+    vector<int> degrees;
+    unordered_map<int, int> vertexOf;  // only when ids are not ascending (e.g. spatially ordered)
+    bool stale = false;
+    Py_ssize_t exports = 0;
+    
+    void setSnapshot(CompactGraph graph) {
+        snapshot = move(graph);
+        colors.assign(snapshot.numVertices(), -1);
+        degrees.resize(snapshot.numVertices());
+        for (int v = 0; v < snapshot.numVertices(); v++) degrees[v] = snapshot.degree(v);
+        vertexOf.clear();
+        if (!is_sorted(snapshot.ids.begin(), snapshot.ids.end())) {
+            for (int v = 0; v < snapshot.numVertices(); v++) vertexOf[snapshot.ids[v]] = v;
+        }
+        stale = false;
+    }
+    
+    void refresh() {
+        if (!stale) return;
+        setSnapshot(builder->compact());
+        colors = builder->getColors(snapshot);
+    }
+    
+    Graph& edit() {
+        if (!builder) builder = make_unique<Graph>(Graph::fromCompact(snapshot));
+        if (!stale) builder->applyColors(snapshot, colors);
+        stale = true;
+        return *builder;
+    }
+};
+
+typedef struct {
+    PyObject_HEAD
+    NativeGraph* native;
+} GraphObject;
+
+// Buffer over one of a graph's arrays; counts as an export for its lifetime
+typedef struct {
+    PyObject_HEAD
+    GraphObject* owner;
+    void* data;
+    const char* format;
+    Py_ssize_t itemSize;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    bool readonly;
+} ArrayViewObject;
+
+typedef struct {
+    PyObject_HEAD
+    GraphObject* graph;
+    PyObject* stats;
+} AssignerObject;
+
+// One node of a graph, looked up by id on each access
+typedef struct {
+    PyObject_HEAD
+    GraphObject* graph;
+    int id;
+} NodeViewObject;
+
+// graph.nodes and graph.edges
+typedef struct {
+    PyObject_HEAD
+    GraphObject* graph;
+} GraphViewObject;
+
+static PyTypeObject GraphType;
+static PyTypeObject ArrayViewType;
+static PyTypeObject AssignerType;
+static PyTypeObject NodeViewType;
+static PyTypeObject NodesType;
+static PyTypeObject EdgesType;
+
+// ---------------------------------------------------------------- array views
+
+static void ArrayView_dealloc(ArrayViewObject* self) {
+    self->owner->native->exports--;
+    Py_DECREF(self->owner);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int ArrayView_getbuffer(ArrayViewObject* self, Py_buffer* view, int flags) {
+    if ((flags & PyBUF_WRITABLE) && self->readonly) {
+        PyErr_SetString(PyExc_BufferError, "array is read-only");
+        return -1;
+    }
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->buf = self->data;
+    view->len = self->shape[0] * (self->ndim == 2 ? self->shape[1] : 1) * self->itemSize;
+    view->readonly = self->readonly;
+    view->itemsize = self->itemSize;
+    view->format = (flags & PyBUF_FORMAT) ? (char*)self->format : nullptr;
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+static PyBufferProcs ArrayViewBuffer = {(getbufferproc)ArrayView_getbuffer, nullptr};
+
+// NumPy array over the view when NumPy is installed, memoryview otherwise
+static PyObject* makeArray(GraphObject* owner, void* data, const char* format, Py_ssize_t itemSize,
+                           Py_ssize_t rows, Py_ssize_t cols, bool readonly) {
+    ArrayViewObject* view = PyObject_New(ArrayViewObject, &ArrayViewType);
+    if (!view) return nullptr;
+    Py_INCREF(owner);
+    owner->native->exports++;
+    view->owner = owner;
+    view->data = data;
+    view->format = format;
+    view->itemSize = itemSize;
+    view->ndim = cols > 0 ? 2 : 1;
+    view->shape[0] = rows;
+    view->shape[1] = cols;
+    view->strides[0] = itemSize * (cols > 0 ? cols : 1);
+    view->strides[1] = itemSize;
+    view->readonly = readonly;
+    
+    PyObject* result = nullptr;
+    PyObject* numpy = PyImport_ImportModule("numpy");
+    if (numpy) {
+        result = PyObject_CallMethod(numpy, "asarray", "O", (PyObject*)view);
+        Py_DECREF(numpy);
+    } else {
+        PyErr_Clear();
+        result = PyMemoryView_FromObject((PyObject*)view);
+    }
+    Py_DECREF(view);
+    return result;
+}
+
+// ---------------------------------------------------------------------- Graph
+
+static bool ensureEditable(GraphObject* self) {
+    if (self->native->exports > 0) {
+        PyErr_SetString(PyExc_BufferError, "graph has live array views or a running engine; release them first");
+        return false;
+    }
+    return true;
+}
+
+static PyObject* Graph_new(PyTypeObject* type, PyObject*, PyObject*) {
+    GraphObject* self = (GraphObject*)type->tp_alloc(type, 0);
+    if (self) self->native = new NativeGraph();
+    return (PyObject*)self;
+}
+
+static int Graph_init(GraphObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"num_nodes", nullptr};
+    int numNodes = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", (char**)keywords, &numNodes)) return -1;
+    if (!ensureEditable(self)) return -1;
+    Graph& graph = self->native->edit();
+    for (int i = 0; i < numNodes; i++) graph.addNode(i);
+    return 0;
+}
+
+static void Graph_dealloc(GraphObject* self) {
+    delete self->native;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* wrapGraph(Graph graph) {
+    GraphObject* self = (GraphObject*)Graph_new(&GraphType, nullptr, nullptr);
+    if (!self) return nullptr;
+    self->native->builder = make_unique<Graph>(move(graph));
+    self->native->stale = true;
+    return (PyObject*)self;
+}
+
+static PyObject* Graph_add_node(GraphObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"node_id", "position", nullptr};
+    int id;
+    double x = 0.0, y = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|(dd)", (char**)keywords, &id, &x, &y)) return nullptr;
+    if (!ensureEditable(self)) return nullptr;
+    self->native->edit().addNode(id, x, y);
+    Py_RETURN_NONE;
+}
+
+static PyObject* Graph_add_edge(GraphObject* self, PyObject* args) {
+    int u, v;
+    if (!PyArg_ParseTuple(args, "ii", &u, &v)) return nullptr;
+    if (!ensureEditable(self)) return nullptr;
+    Graph& graph = self->native->edit();
+    if (!graph.hasNode(u) || !graph.hasNode(v)) {
+        PyErr_Format(PyExc_ValueError, "Nodes %d or %d not in graph", u, v);
+        return nullptr;
+    }
+    graph.addEdge(u, v);
+    Py_RETURN_NONE;
+}
+
+static int countColors(const vector<int>& colors) {
+    vector<int> used;
+    for (int color : colors) {
+        if (color != -1) used.push_back(color);
+    }
+    sort(used.begin(), used.end());
+    return (int)(unique(used.begin(), used.end()) - used.begin());
+}
+
+static int countConflicts(const CompactGraph& graph, const vector<int>& colors) {
+    int conflicts = 0;
+    for (int v = 0; v < graph.numVertices(); v++) {
+        for (const int* u = graph.neighborsBegin(v); u != graph.neighborsEnd(v); ++u) {
+            if (*u > v && colors[v] != -1 && colors[v] == colors[*u]) conflicts++;
+        }
+    }
+    return conflicts;
+}
+
+static PyObject* Graph_get_chromatic_number(GraphObject* self, PyObject*) {
+    self->native->refresh();
+    return PyLong_FromLong(countColors(self->native->colors));
+}
+
+static PyObject* Graph_count_conflicts(GraphObject* self, PyObject*) {
+    self->native->refresh();
+    return PyLong_FromLong(countConflicts(self->native->snapshot, self->native->colors));
+}
+
+static PyObject* Graph_reset_colors(GraphObject* self, PyObject*) {
+    self->native->refresh();
+    fill(self->native->colors.begin(), self->native->colors.end(), -1);
+    Py_RETURN_NONE;
+}
+
+// Vertex index of `id` in the snapshot, or -1
+static int findVertex(NativeGraph& native, int id) {
+    native.refresh();
+    if (!native.vertexOf.empty()) {
+        auto found = native.vertexOf.find(id);
+        return found == native.vertexOf.end() ? -1 : found->second;
+    }
+    auto it = lower_bound(native.snapshot.ids.begin(), native.snapshot.ids.end(), id);
+    if (it == native.snapshot.ids.end() || *it != id) return -1;
+    return (int)(it - native.snapshot.ids.begin());
+}
+
+static PyObject* Graph_get_neighbor_colors(GraphObject* self, PyObject* args) {
+    int id;
+    if (!PyArg_ParseTuple(args, "i", &id)) return nullptr;
+    NativeGraph& native = *self->native;
+    int v = findVertex(native, id);
+    if (v == -1) {
+        PyErr_Format(PyExc_KeyError, "%d", id);
+        return nullptr;
+    }
+    PyObject* result = PySet_New(nullptr);
+    for (const int* u = native.snapshot.neighborsBegin(v); result && u != native.snapshot.neighborsEnd(v); ++u) {
+        if (native.colors[*u] == -1) continue;
+        PyObject* color = PyLong_FromLong(native.colors[*u]);
+        if (!color || PySet_Add(result, color) < 0) Py_CLEAR(result);
+        Py_XDECREF(color);
+    }
+    return result;
+}
+
+static PyObject* Graph_get_num_nodes(GraphObject* self, void*) {
+    self->native->refresh();
+    return PyLong_FromLong(self->native->snapshot.numVertices());
+}
+
+static PyObject* Graph_get_num_edges(GraphObject* self, void*) {
+    self->native->refresh();
+    return PyLong_FromSsize_t((Py_ssize_t)self->native->snapshot.numEdges());
+}
+
+static PyObject* Graph_get_ids(GraphObject* self, void*) {
+    NativeGraph& native = *self->native;
+    native.refresh();
+    return makeArray(self, native.snapshot.ids.data(), "i", sizeof(int), native.snapshot.numVertices(), 0, true);
+}
+
+static PyObject* Graph_get_colors(GraphObject* self, void*) {
+    NativeGraph& native = *self->native;
+    native.refresh();
+    return makeArray(self, native.colors.data(), "i", sizeof(int), native.snapshot.numVertices(), 0, false);
+}
+
+static PyObject* Graph_get_degrees(GraphObject* self, void*) {
+    NativeGraph& native = *self->native;
+    native.refresh();
+    return makeArray(self, native.degrees.data(), "i", sizeof(int), native.snapshot.numVertices(), 0, true);
+}
+
+static PyObject* Graph_get_positions(GraphObject* self, void*) {
+    NativeGraph& native = *self->native;
+    native.refresh();
+    static_assert(sizeof(pair<double, double>) == 2 * sizeof(double), "positions must be packed");
+    return makeArray(self, native.snapshot.positions.data(), "d", sizeof(double), native.snapshot.numVertices(), 2,
+                     true);
+}
+
+// Row-major or strided (rows, 2) matrix from a buffer, read in place
+struct BufferMatrix {
+    Py_buffer view = {};
+    char kind = 0;  // 'i' signed, 'u' unsigned, 'f' floating
+    
+    ~BufferMatrix() {
+        if (view.obj) PyBuffer_Release(&view);
+    }
+    
+    // Sets a Python error and returns false if obj is not a (rows, 2) array of the wanted kind
+    bool acquire(PyObject* obj, const char* name, bool floating) {
+        if (PyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) < 0) {
+            PyErr_Format(PyExc_TypeError, "%s must be an (N, 2) array supporting the buffer protocol", name);
+            return false;
+        }
+        const char* format = view.format;
+        if (*format == '@' || *format == '=' || *format == '<') format++;
+        if (format[0] && !format[1]) {
+            if (strchr("bhilq", format[0])) kind = 'i';
+            if (strchr("BHILQ", format[0])) kind = 'u';
+            if (strchr("fd", format[0])) kind = 'f';
+        }
+        bool sizeOk = view.itemsize == 4 || view.itemsize == 8;
+        if (view.ndim != 2 || view.shape[1] != 2 || !sizeOk || (kind == 'f') != floating || !kind) {
+            PyErr_Format(PyExc_ValueError, "%s must have shape (N, 2) and dtype %s", name,
+                         floating ? "float32 or float64" : "int32 or int64");
+            return false;
+        }
+        return true;
+    }
+    
+    size_t rows() const { return (size_t)view.shape[0]; }
+    
+    const char* at(size_t row, int col) const {
+        return (const char*)view.buf + row * view.strides[0] + col * view.strides[1];
+    }
+    
+    int64_t integer(size_t row, int col) const {
+        const char* p = at(row, col);
+        if (view.itemsize == 4) {
+            int32_t value;
+            memcpy(&value, p, 4);
+            return kind == 'u' ? (int64_t)(uint32_t)value : value;
+        }
+        int64_t value;
+        memcpy(&value, p, 8);
+        return kind == 'u' && value < 0 ? INT64_MAX : value;
+    }
+    
+    double real(size_t row, int col) const {
+        const char* p = at(row, col);
+        if (view.itemsize == 4) {
+            float value;
+            memcpy(&value, p, 4);
+            return value;
+        }
+        double value;
+        memcpy(&value, p, 8);
+        return value;
+    }
+};
+
+// Graph.from_edges(edges, positions=None, num_nodes=None): bulk CSR build from
+// an (E, 2) integer array over nodes 0..N-1, reading the buffer in place
+static PyObject* Graph_from_edges(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"edges", "positions", "num_nodes", nullptr};
+    PyObject* edgesArg;
+    PyObject* positionsArg = Py_None;
+    PyObject* numNodesArg = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO", (char**)keywords, &edgesArg, &positionsArg,
+                                     &numNodesArg)) {
+        return nullptr;
+    }
+    Py_ssize_t numNodes = -1;
+    if (numNodesArg != Py_None) {
+        numNodes = PyNumber_AsSsize_t(numNodesArg, PyExc_OverflowError);
+        if (numNodes == -1 && PyErr_Occurred()) return nullptr;
+        if (numNodes < 0) {
+            PyErr_SetString(PyExc_ValueError, "num_nodes must be non-negative");
+            return nullptr;
+        }
+    }
+    
+    BufferMatrix edges, positions;
+    if (!edges.acquire(edgesArg, "edges", false)) return nullptr;
+    bool hasPositions = positionsArg != Py_None;
+    if (hasPositions && !positions.acquire(positionsArg, "positions", true)) return nullptr;
+    if (hasPositions && numNodes >= 0 && (size_t)numNodes != positions.rows()) {
+        PyErr_SetString(PyExc_ValueError, "num_nodes does not match the number of positions");
+        return nullptr;
+    }
+    
+    size_t numEdges = edges.rows();
+    int64_t lowest = 0, highest = -1;
+    CompactGraph graph;
+    bool inRange;
+    Py_BEGIN_ALLOW_THREADS
+    for (size_t e = 0; e < numEdges; e++) {
+        for (int k = 0; k < 2; k++) {
+            int64_t id = edges.integer(e, k);
+            lowest = min(lowest, id);
+            highest = max(highest, id);
+        }
+    }
+    int64_t n = numNodes >= 0 ? numNodes : hasPositions ? (int64_t)positions.rows() : highest + 1;
+    inRange = lowest >= 0 && highest < n && n <= INT_MAX;
+    if (inRange) {
+        vector<pair<double, double>> points;
+        if (hasPositions) {
+            points.resize(n);
+            for (int64_t v = 0; v < n; v++) points[v] = {positions.real(v, 0), positions.real(v, 1)};
+        }
+        graph = CompactGraph::fromEdgeSource(
+            (int)n, numEdges, [&](size_t e) { return make_pair((int)edges.integer(e, 0), (int)edges.integer(e, 1)); },
+            move(points));
+    }
+    Py_END_ALLOW_THREADS
+    
+    if (!inRange) {
+        PyErr_SetString(PyExc_ValueError, "edge endpoints must lie in [0, num_nodes) and fit in int32");
+        return nullptr;
+    }
+    GraphObject* self = (GraphObject*)Graph_new(&GraphType, nullptr, nullptr);
+    if (self) self->native->setSnapshot(move(graph));
+    return (PyObject*)self;
+}
+
+static Py_ssize_t Graph_len(GraphObject* self) {
+    self->native->refresh();
+    return self->native->snapshot.numVertices();
+}
+
+// ------------------------------------------------------- node and edge views
+
+static PyObject* makeNodeView(GraphObject* graph, int id) {
+    NodeViewObject* node = PyObject_New(NodeViewObject, &NodeViewType);
+    if (!node) return nullptr;
+    Py_INCREF(graph);
+    node->graph = graph;
+    node->id = id;
+    return (PyObject*)node;
+}
+
+static PyObject* makeGraphView(PyTypeObject* type, GraphObject* graph) {
+    GraphViewObject* view = PyObject_New(GraphViewObject, type);
+    if (!view) return nullptr;
+    Py_INCREF(graph);
+    view->graph = graph;
+    return (PyObject*)view;
+}
+
+static void NodeView_dealloc(NodeViewObject* self) {
+    Py_DECREF(self->graph);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static void GraphView_dealloc(GraphViewObject* self) {
+    Py_DECREF(self->graph);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// Looks the node up again on every access, so a view survives later edits
+static int nodeVertex(NodeViewObject* self) {
+    int v = findVertex(*self->graph->native, self->id);
+    if (v == -1) PyErr_Format(PyExc_KeyError, "%d", self->id);
+    return v;
+}
+
+static PyObject* NodeView_get_id(NodeViewObject* self, void*) {
+    return PyLong_FromLong(self->id);
+}
+
+static PyObject* NodeView_get_color(NodeViewObject* self, void*) {
+    int v = nodeVertex(self);
+    if (v == -1) return nullptr;
+    int color = self->graph->native->colors[v];
+    if (color == -1) Py_RETURN_NONE;
+    return PyLong_FromLong(color);
+}
+
+static int NodeView_set_color(NodeViewObject* self, PyObject* value, void*) {
+    int v = nodeVertex(self);
+    if (v == -1) return -1;
+    long color = -1;
+    if (value && value != Py_None) {
+        color = PyLong_AsLong(value);
+        if (color == -1 && PyErr_Occurred()) return -1;
+        if (color < 0 || color > INT_MAX) {
+            PyErr_SetString(PyExc_ValueError, "color must be a non-negative int or None");
+            return -1;
+        }
+    }
+    self->graph->native->colors[v] = (int)color;
+    return 0;
+}
+
+static PyObject* NodeView_get_degree(NodeViewObject* self, void*) {
+    int v = nodeVertex(self);
+    if (v == -1) return nullptr;
+    return PyLong_FromLong(self->graph->native->degrees[v]);
+}
+
+static PyObject* NodeView_get_position(NodeViewObject* self, void*) {
+    int v = nodeVertex(self);
+    if (v == -1) return nullptr;
+    auto [x, y] = self->graph->native->snapshot.positions[v];
+    return Py_BuildValue("(dd)", x, y);
+}
+
+static PyObject* NodeView_get_neighbors(NodeViewObject* self, void*) {
+    int v = nodeVertex(self);
+    if (v == -1) return nullptr;
+    const CompactGraph& graph = self->graph->native->snapshot;
+    PyObject* result = PySet_New(nullptr);
+    for (const int* u = graph.neighborsBegin(v); result && u != graph.neighborsEnd(v); ++u) {
+        PyObject* id = PyLong_FromLong(graph.ids[*u]);
+        if (!id || PySet_Add(result, id) < 0) Py_CLEAR(result);
+        Py_XDECREF(id);
+    }
+    return result;
+}
+
+static PyObject* NodeView_repr(NodeViewObject* self) {
+    int v = nodeVertex(self);
+    if (v == -1) return nullptr;
+    NativeGraph& native = *self->graph->native;
+    if (native.colors[v] == -1) return PyUnicode_FromFormat("Node(id=%d, color=None, degree=%d)", self->id,
+                                                             native.degrees[v]);
+    return PyUnicode_FromFormat("Node(id=%d, color=%d, degree=%d)", self->id, native.colors[v], native.degrees[v]);
+}
+
+static PyGetSetDef NodeViewGetSet[] = {
+    {"id", (getter)NodeView_get_id, nullptr, "Node id", nullptr},
+    {"color", (getter)NodeView_get_color, (setter)NodeView_set_color, "Color, or None if uncolored", nullptr},
+    {"degree", (getter)NodeView_get_degree, nullptr, "Number of neighbors", nullptr},
+    {"position", (getter)NodeView_get_position, nullptr, "(x, y) position", nullptr},
+    {"neighbors", (getter)NodeView_get_neighbors, nullptr, "Set of neighbor ids", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+// graph.nodes: read-only mapping from id to node view, in vertex order
+static Py_ssize_t Nodes_len(GraphViewObject* self) {
+    self->graph->native->refresh();
+    return self->graph->native->snapshot.numVertices();
+}
+
+static bool parseNodeId(PyObject* key, int& id) {
+    long value = PyLong_AsLong(key);
+    if (value == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return false;
+    }
+    id = (int)value;
+    return value >= INT_MIN && value <= INT_MAX;
+}
+
+static PyObject* Nodes_getitem(GraphViewObject* self, PyObject* key) {
+    int id;
+    if (!parseNodeId(key, id) || findVertex(*self->graph->native, id) == -1) {
+        PyErr_SetObject(PyExc_KeyError, key);
+        return nullptr;
+    }
+    return makeNodeView(self->graph, id);
+}
+
+static int Nodes_contains(GraphViewObject* self, PyObject* key) {
+    int id;
+    return parseNodeId(key, id) && findVertex(*self->graph->native, id) != -1;
+}
+
+// List of ids, node views or (id, node view) pairs
+static PyObject* nodeList(GraphViewObject* self, bool withIds, bool withNodes) {
+    NativeGraph& native = *self->graph->native;
+    native.refresh();
+    PyObject* list = PyList_New(native.snapshot.numVertices());
+    for (int v = 0; list && v < native.snapshot.numVertices(); v++) {
+        int id = native.snapshot.ids[v];
+        PyObject* item = nullptr;
+        if (withIds && withNodes) {
+            PyObject* node = makeNodeView(self->graph, id);
+            item = node ? Py_BuildValue("(iN)", id, node) : nullptr;
+        } else {
+            item = withIds ? PyLong_FromLong(id) : makeNodeView(self->graph, id);
+        }
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, v, item);
+    }
+    return list;
+}
+
+static PyObject* Nodes_keys(GraphViewObject* self, PyObject*) { return nodeList(self, true, false); }
+static PyObject* Nodes_values(GraphViewObject* self, PyObject*) { return nodeList(self, false, true); }
+static PyObject* Nodes_items(GraphViewObject* self, PyObject*) { return nodeList(self, true, true); }
+
+static PyObject* Nodes_iter(GraphViewObject* self) {
+    PyObject* keys = nodeList(self, true, false);
+    if (!keys) return nullptr;
+    PyObject* iterator = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return iterator;
+}
+
+static PyMethodDef NodesMethods[] = {
+    {"keys", (PyCFunction)Nodes_keys, METH_NOARGS, "Node ids in vertex order"},
+    {"values", (PyCFunction)Nodes_values, METH_NOARGS, "Node views in vertex order"},
+    {"items", (PyCFunction)Nodes_items, METH_NOARGS, "(id, node view) pairs in vertex order"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+// Slot tables are filled in PyInit, like the type objects
+static PyMappingMethods NodesMapping;
+static PySequenceMethods NodesSequence;
+
+// graph.edges: (u, v) id pairs of the snapshot, each edge once with u < v
+static Py_ssize_t Edges_len(GraphViewObject* self) {
+    self->graph->native->refresh();
+    return (Py_ssize_t)self->graph->native->snapshot.numEdges();
+}
+
+static PyObject* Edges_iter(GraphViewObject* self) {
+    NativeGraph& native = *self->graph->native;
+    native.refresh();
+    const CompactGraph& graph = native.snapshot;
+    PyObject* list = PyList_New(0);
+    for (int v = 0; list && v < graph.numVertices(); v++) {
+        for (const int* u = graph.neighborsBegin(v); list && u != graph.neighborsEnd(v); ++u) {
+            if (*u < v) continue;
+            PyObject* edge = Py_BuildValue("(ii)", graph.ids[v], graph.ids[*u]);
+            if (!edge || PyList_Append(list, edge) < 0) Py_CLEAR(list);
+            Py_XDECREF(edge);
+        }
+    }
+    if (!list) return nullptr;
+    PyObject* iterator = PyObject_GetIter(list);
+    Py_DECREF(list);
+    return iterator;
+}
+
+static PySequenceMethods EdgesSequence;
+
+static PyObject* Graph_get_nodes(GraphObject* self, void*) {
+    return makeGraphView(&NodesType, self);
+}
+
+static PyObject* Graph_get_edges(GraphObject* self, void*) {
+    return makeGraphView(&EdgesType, self);
+}
+
+static PyMethodDef GraphMethods[] = {
+    {"add_node", (PyCFunction)(void (*)(void))Graph_add_node, METH_VARARGS | METH_KEYWORDS,
+     "add_node(node_id, position=(0.0, 0.0))"},
+    {"add_edge", (PyCFunction)Graph_add_edge, METH_VARARGS, "add_edge(u, v); ValueError if either node is missing"},
+    {"get_neighbor_colors", (PyCFunction)Graph_get_neighbor_colors, METH_VARARGS,
+     "Set of colors used by the node's neighbors"},
+    {"get_chromatic_number", (PyCFunction)Graph_get_chromatic_number, METH_NOARGS, "Number of distinct colors"},
+    {"count_conflicts", (PyCFunction)Graph_count_conflicts, METH_NOARGS, "Edges whose endpoints share a color"},
+    {"reset_colors", (PyCFunction)Graph_reset_colors, METH_NOARGS, "Mark every node uncolored (-1)"},
+    {"from_edges", (PyCFunction)(void (*)(void))Graph_from_edges, METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     "from_edges(edges, positions=None, num_nodes=None): build from an (E, 2) int32/int64 array"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+static PyGetSetDef GraphGetSet[] = {
+    {"num_nodes", (getter)Graph_get_num_nodes, nullptr, "Number of nodes", nullptr},
+    {"num_edges", (getter)Graph_get_num_edges, nullptr, "Number of edges", nullptr},
+    {"ids", (getter)Graph_get_ids, nullptr, "Node id per vertex (read-only int32 view)", nullptr},
+    {"colors", (getter)Graph_get_colors, nullptr, "Color per node, -1 if uncolored (writable int32 view)", nullptr},
+    {"degrees", (getter)Graph_get_degrees, nullptr, "Degree per node (read-only int32 view)", nullptr},
+    {"positions", (getter)Graph_get_positions, nullptr, "(N, 2) positions (read-only float64 view)", nullptr},
+    {"nodes", (getter)Graph_get_nodes, nullptr, "Read-only mapping from node id to node view", nullptr},
+    {"edges", (getter)Graph_get_edges, nullptr, "(u, v) id pairs, each edge once", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+static PySequenceMethods GraphSequence;
+
+// ----------------------------------------------------------- FrequencyAssigner
+
+// Plain backtracking in vertex order, as in graph_coloring.py. Iterative, with
+// `colors` as the stack: vertices after v are always uncolored, and stepping
+// back resumes v's predecessor at its next color, so any size is safe.
+static bool backtrack(const CompactGraph& graph, vector<int>& colors, int maxColors) {
+    int n = graph.numVertices();
+    int v = 0;
+    while (v >= 0 && v < n) {
+        int color = colors[v] + 1;
+        for (; color < maxColors; color++) {
+            bool free = true;
+            for (const int* u = graph.neighborsBegin(v); free && u != graph.neighborsEnd(v); ++u) {
+                free = colors[*u] != color;
+            }
+            if (free) break;
+        }
+        if (color < maxColors) {
+            colors[v++] = color;
+        } else {
+            colors[v--] = -1;
+        }
+    }
+    return v == n;
+}
+
+static int Assigner_init(AssignerObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"graph", nullptr};
+    PyObject* graph;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", (char**)keywords, &GraphType, &graph)) return -1;
+    Py_INCREF(graph);
+    Py_XSETREF(self->graph, (GraphObject*)graph);
+    Py_XSETREF(self->stats, Py_BuildValue("{s:s,s:i,s:i,s:i,s:d}", "algorithm", "", "chromatic_number", 0,
+                                          "conflicts", 0, "time_ms", 0, "efficiency", 0.0));
+    return self->stats ? 0 : -1;
+}
+
+static void Assigner_dealloc(AssignerObject* self) {
+    Py_XDECREF(self->graph);
+    Py_XDECREF(self->stats);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static bool checkAssigner(AssignerObject* self) {
+    if (!self->graph) PyErr_SetString(PyExc_RuntimeError, "FrequencyAssigner.__init__ was not called");
+    return self->graph != nullptr;
+}
+
+static PyObject* computeStats(AssignerObject* self, const char* label, double elapsedMs) {
+    NativeGraph& native = *self->graph->native;
+    int nodes = native.snapshot.numVertices();
+    int chromatic = countColors(native.colors);
+    double efficiency = nodes > 0 ? (nodes - chromatic) / (double)nodes * 100.0 : 0.0;
+    PyObject* stats = Py_BuildValue(
+        "{s:s,s:i,s:i,s:d,s:d,s:i,s:n}", "algorithm", label, "chromatic_number", chromatic, "conflicts",
+        countConflicts(native.snapshot, native.colors), "time_ms", round(elapsedMs * 100.0) / 100.0, "efficiency",
+        round(efficiency * 100.0) / 100.0, "nodes", nodes, "edges", (Py_ssize_t)native.snapshot.numEdges());
+    if (!stats) return nullptr;
+    Py_XSETREF(self->stats, stats);
+    Py_INCREF(stats);
+    return stats;
+}
+
+// Run a named engine on the snapshot without the GIL; the running engine holds
+// an export so the topology cannot change underneath it
+static PyObject* runEngine(AssignerObject* self, const char* algorithm, const RunSettings& settings) {
+    if (!checkAssigner(self)) return nullptr;
+    NativeGraph& native = *self->graph->native;
+    native.refresh();
+    vector<int> colors;
+    native.exports++;
+    auto start = chrono::high_resolution_clock::now();
+    Py_BEGIN_ALLOW_THREADS
+    runAlgorithm(native.snapshot, algorithm, settings, colors);
+    Py_END_ALLOW_THREADS
+    double elapsed = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    native.exports--;
+    copy(colors.begin(), colors.end(), native.colors.begin());
+    return computeStats(self, algorithmLabel(algorithm).c_str(), elapsed);
+}
+
+static PyObject* Assigner_greedy_coloring(AssignerObject* self, PyObject*) {
+    return runEngine(self, "greedy", RunSettings());
+}
+
+static PyObject* Assigner_welsh_powell(AssignerObject* self, PyObject*) {
+    return runEngine(self, "welsh_powell", RunSettings());
+}
+
+static PyObject* Assigner_dsatur(AssignerObject* self, PyObject*) {
+    return runEngine(self, "dsatur", RunSettings());
+}
+
+static PyObject* Assigner_hybrid_evolutionary(AssignerObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"time_budget_ms", "seed", "threads", nullptr};
+    RunSettings settings;
+    settings.timeBudgetMs = 1000.0;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dKi", (char**)keywords, &settings.timeBudgetMs,
+                                     &settings.seed, &threads)) {
+        return nullptr;
+    }
+    if (threads > 0) settings.threads = threads;
+    return runEngine(self, "hea", settings);
+}
+
+static PyObject* Assigner_color_by_components(AssignerObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"threads", nullptr};
+    RunSettings settings;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", (char**)keywords, &threads)) return nullptr;
+    if (threads > 0) settings.threads = threads;
+    return runEngine(self, "components", settings);
+}
+
+static PyObject* Assigner_color_by_partition(AssignerObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"shards", "threads", nullptr};
+    RunSettings settings;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ii", (char**)keywords, &settings.shards, &threads)) {
+        return nullptr;
+    }
+    if (threads > 0) settings.threads = threads;
+    return runEngine(self, "partition", settings);
+}
+
+static PyObject* Assigner_periodic_grid_coloring(AssignerObject* self, PyObject*) {
+    return runEngine(self, "periodic", RunSettings());
+}
+
+static PyObject* Assigner_backtracking_exact(AssignerObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"max_colors", nullptr};
+    PyObject* maxColorsArg = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", (char**)keywords, &maxColorsArg)) return nullptr;
+    if (!checkAssigner(self)) return nullptr;
+    NativeGraph& native = *self->graph->native;
+    native.refresh();
+    int maxColors = native.snapshot.numVertices();
+    if (maxColorsArg != Py_None) {
+        maxColors = (int)PyLong_AsLong(maxColorsArg);
+        if (PyErr_Occurred()) return nullptr;
+    }
+    
+    vector<int> colors(native.snapshot.numVertices(), -1);
+    bool found;
+    native.exports++;
+    auto start = chrono::high_resolution_clock::now();
+    Py_BEGIN_ALLOW_THREADS
+    found = backtrack(native.snapshot, colors, maxColors);
+    Py_END_ALLOW_THREADS
+    double elapsed = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+    native.exports--;
+    if (!found) return Py_BuildValue("{s:s}", "error", "No solution found with given color limit");
+    copy(colors.begin(), colors.end(), native.colors.begin());
+    return computeStats(self, "Backtracking-Exact", elapsed);
+}
+
+static PyObject* Assigner_get_smallest_available_color(AssignerObject*, PyObject* args) {
+    PyObject* neighborColors;
+    if (!PyArg_ParseTuple(args, "O", &neighborColors)) return nullptr;
+    for (long color = 0;; color++) {
+        PyObject* value = PyLong_FromLong(color);
+        if (!value) return nullptr;
+        int taken = PySequence_Contains(neighborColors, value);
+        if (taken != 1) {
+            if (taken == 0) return value;
+            Py_DECREF(value);
+            return nullptr;
+        }
+        Py_DECREF(value);
+    }
+}
+
+static PyObject* Assigner_export_assignment(AssignerObject* self, PyObject* args) {
+    const char* filename;
+    if (!PyArg_ParseTuple(args, "s", &filename)) return nullptr;
+    if (!checkAssigner(self)) return nullptr;
+    NativeGraph& native = *self->graph->native;
+    native.refresh();
+    
+    PyObject* json = PyImport_ImportModule("json");
+    if (!json) return nullptr;
+    PyObject* metadata = PyObject_CallMethod(json, "dumps", "O", self->stats);
+    Py_DECREF(json);
+    if (!metadata) return nullptr;
+    const char* metadataText = PyUnicode_AsUTF8(metadata);
+    if (!metadataText) {
+        Py_DECREF(metadata);
+        return nullptr;
+    }
+    
+    ofstream file(filename);
+    if (!file.is_open()) {
+        Py_DECREF(metadata);
+        return PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+    }
+    const CompactGraph& graph = native.snapshot;
+    file << "{\n  \"metadata\": " << metadataText << ",\n  \"assignments\": [\n";
+    Py_DECREF(metadata);
+    for (int v = 0; v < graph.numVertices(); v++) {
+        file << "    {\"node_id\": " << graph.ids[v] << ", \"frequency\": ";
+        if (native.colors[v] == -1) {
+            file << "null";
+        } else {
+            file << native.colors[v];
+        }
+        file << ", \"position\": [" << graph.positions[v].first << ", " << graph.positions[v].second
+             << "], \"degree\": " << native.degrees[v] << "}" << (v + 1 < graph.numVertices() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+    if (!file) return PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+    
+    PySys_WriteStdout("✓ Assignment exported to %s\n", filename);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef AssignerMethods[] = {
+    {"greedy_coloring", (PyCFunction)Assigner_greedy_coloring, METH_NOARGS, "First-fit in id order"},
+    {"welsh_powell", (PyCFunction)Assigner_welsh_powell, METH_NOARGS, "First-fit by decreasing degree"},
+    {"largest_first", (PyCFunction)Assigner_welsh_powell, METH_NOARGS, "Same as welsh_powell"},
+    {"dsatur", (PyCFunction)Assigner_dsatur, METH_NOARGS, "Degree of saturation"},
+    {"backtracking_exact", (PyCFunction)(void (*)(void))Assigner_backtracking_exact, METH_VARARGS | METH_KEYWORDS,
+     "backtracking_exact(max_colors=None); exponential, small graphs only"},
+    {"hybrid_evolutionary", (PyCFunction)(void (*)(void))Assigner_hybrid_evolutionary,
+     METH_VARARGS | METH_KEYWORDS, "hybrid_evolutionary(time_budget_ms=1000, seed=42, threads=0)"},
+    {"color_by_components", (PyCFunction)(void (*)(void))Assigner_color_by_components,
+     METH_VARARGS | METH_KEYWORDS, "color_by_components(threads=0)"},
+    {"color_by_partition", (PyCFunction)(void (*)(void))Assigner_color_by_partition, METH_VARARGS | METH_KEYWORDS,
+     "color_by_partition(shards=4, threads=0)"},
+    {"periodic_grid_coloring", (PyCFunction)Assigner_periodic_grid_coloring, METH_NOARGS,
+     "Closed-form lattice coloring where the network is grid-like"},
+    {"get_smallest_available_color", (PyCFunction)Assigner_get_smallest_available_color, METH_VARARGS,
+     "Smallest color not in neighbor_colors"},
+    {"export_assignment", (PyCFunction)Assigner_export_assignment, METH_VARARGS, "Write assignments to JSON"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+static PyMemberDef AssignerMembers[] = {
+    {"graph", T_OBJECT_EX, offsetof(AssignerObject, graph), READONLY, "Graph being colored"},
+    {"stats", T_OBJECT_EX, offsetof(AssignerObject, stats), READONLY, "Statistics of the last run"},
+    {nullptr, 0, 0, 0, nullptr},
+};
+
+// ------------------------------------------------------------ NetworkGenerator
+
+static PyObject* Generator_random_geometric(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"num_nodes", "radius", "area", "seed", nullptr};
+    int numNodes;
+    double radius, width = 1000, height = 1000;
+    unsigned long long seed = 42;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "id|(dd)K", (char**)keywords, &numNodes, &radius, &width,
+                                     &height, &seed)) {
+        return nullptr;
+    }
+    CompactGraph graph;
+    Py_BEGIN_ALLOW_THREADS
+    graph = NetworkGenerator::randomGeometricCompact(numNodes, radius, width, height, seed);
+    Py_END_ALLOW_THREADS
+    GraphObject* self = (GraphObject*)Graph_new(&GraphType, nullptr, nullptr);
+    if (self) self->native->setSnapshot(move(graph));
+    return (PyObject*)self;
+}
+
+static PyObject* Generator_cellular_grid(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"rows", "cols", "connectivity", nullptr};
+    int rows, cols;
+    const char* connectivity = "hex";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ii|s", (char**)keywords, &rows, &cols, &connectivity)) {
+        return nullptr;
+    }
+    if (strcmp(connectivity, "hex") == 0) return wrapGraph(NetworkGenerator::cellularGrid(rows, cols));
+    if (strcmp(connectivity, "square") != 0) {
+        PyErr_Format(PyExc_ValueError, "connectivity must be 'hex' or 'square', not '%s'", connectivity);
+        return nullptr;
+    }
+    
+    vector<pair<int, int>> edges;
+    vector<pair<double, double>> positions;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int id = i * cols + j;
+            positions.push_back({j * 100.0, i * 100.0});
+            if (j < cols - 1) edges.push_back({id, id + 1});
+            if (i < rows - 1) edges.push_back({id, id + cols});
+        }
+    }
+    GraphObject* self = (GraphObject*)Graph_new(&GraphType, nullptr, nullptr);
+    if (self) self->native->setSnapshot(CompactGraph::fromEdges(max(0, rows * cols), edges, positions));
+    return (PyObject*)self;
+}
+
+static PyObject* Generator_scale_free(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"num_nodes", "m", "seed", nullptr};
+    int numNodes, m = 3;
+    unsigned long long seed = 42;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|iK", (char**)keywords, &numNodes, &m, &seed)) return nullptr;
+    return wrapGraph(NetworkGenerator::scaleFree(numNodes, m, seed));
+}
+
+static PyMethodDef GeneratorMethods[] = {
+    {"random_geometric", (PyCFunction)(void (*)(void))Generator_random_geometric,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, "random_geometric(num_nodes, radius, area=(1000, 1000), seed=42)"},
+    {"cellular_grid", (PyCFunction)(void (*)(void))Generator_cellular_grid, METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     "cellular_grid(rows, cols, connectivity='hex')"},
+    {"scale_free", (PyCFunction)(void (*)(void))Generator_scale_free, METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     "scale_free(num_nodes, m=3, seed=42)"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+static PyTypeObject GeneratorType;
+
+// --------------------------------------------------------------------- module
+
+static PyModuleDef NativeModule = {
+    PyModuleDef_HEAD_INIT, "graph_coloring_native", "C++ graph coloring engines for frequency assignment", -1,
+    nullptr, nullptr, nullptr, nullptr, nullptr,
+};
+
+PyMODINIT_FUNC PyInit_graph_coloring_native(void) {
+    GraphType.tp_name = "graph_coloring_native.Graph";
+    GraphType.tp_doc = "Graph(num_nodes=0): interference graph backed by the C++ engine";
+    GraphType.tp_basicsize = sizeof(GraphObject);
+    GraphType.tp_flags = Py_TPFLAGS_DEFAULT;
+    GraphType.tp_new = Graph_new;
+    GraphType.tp_init = (initproc)Graph_init;
+    GraphType.tp_dealloc = (destructor)Graph_dealloc;
+    GraphType.tp_methods = GraphMethods;
+    GraphType.tp_getset = GraphGetSet;
+    GraphSequence.sq_length = (lenfunc)Graph_len;
+    GraphType.tp_as_sequence = &GraphSequence;
+    
+    ArrayViewType.tp_name = "graph_coloring_native.ArrayView";
+    ArrayViewType.tp_basicsize = sizeof(ArrayViewObject);
+    ArrayViewType.tp_flags = Py_TPFLAGS_DEFAULT;
+    ArrayViewType.tp_dealloc = (destructor)ArrayView_dealloc;
+    ArrayViewType.tp_as_buffer = &ArrayViewBuffer;
+    
+    NodeViewType.tp_name = "graph_coloring_native.Node";
+    NodeViewType.tp_doc = "Node of a native Graph; color is writable, the rest is read-only";
+    NodeViewType.tp_basicsize = sizeof(NodeViewObject);
+    NodeViewType.tp_flags = Py_TPFLAGS_DEFAULT;
+    NodeViewType.tp_dealloc = (destructor)NodeView_dealloc;
+    NodeViewType.tp_repr = (reprfunc)NodeView_repr;
+    NodeViewType.tp_getset = NodeViewGetSet;
+    
+    NodesType.tp_name = "graph_coloring_native.NodesView";
+    NodesType.tp_basicsize = sizeof(GraphViewObject);
+    NodesType.tp_flags = Py_TPFLAGS_DEFAULT;
+    NodesType.tp_dealloc = (destructor)GraphView_dealloc;
+    NodesMapping.mp_length = (lenfunc)Nodes_len;
+    NodesMapping.mp_subscript = (binaryfunc)Nodes_getitem;
+    NodesSequence.sq_contains = (objobjproc)Nodes_contains;
+    NodesType.tp_as_mapping = &NodesMapping;
+    NodesType.tp_as_sequence = &NodesSequence;
+    NodesType.tp_iter = (getiterfunc)Nodes_iter;
+    NodesType.tp_methods = NodesMethods;
+    
+    EdgesType.tp_name = "graph_coloring_native.EdgesView";
+    EdgesType.tp_basicsize = sizeof(GraphViewObject);
+    EdgesType.tp_flags = Py_TPFLAGS_DEFAULT;
+    EdgesType.tp_dealloc = (destructor)GraphView_dealloc;
+    EdgesSequence.sq_length = (lenfunc)Edges_len;
+    EdgesType.tp_as_sequence = &EdgesSequence;
+    EdgesType.tp_iter = (getiterfunc)Edges_iter;
+    
+    AssignerType.tp_name = "graph_coloring_native.FrequencyAssigner";
+    AssignerType.tp_doc = "FrequencyAssigner(graph): same methods as graph_coloring.FrequencyAssigner";
+    AssignerType.tp_basicsize = sizeof(AssignerObject);
+    AssignerType.tp_flags = Py_TPFLAGS_DEFAULT;
+    AssignerType.tp_new = PyType_GenericNew;
+    AssignerType.tp_init = (initproc)Assigner_init;
+    AssignerType.tp_dealloc = (destructor)Assigner_dealloc;
+    AssignerType.tp_methods = AssignerMethods;
+    AssignerType.tp_members = AssignerMembers;
+    
+    GeneratorType.tp_name = "graph_coloring_native.NetworkGenerator";
+    GeneratorType.tp_doc = "Network topologies generated in C++";
+    GeneratorType.tp_basicsize = sizeof(PyObject);
+    GeneratorType.tp_flags = Py_TPFLAGS_DEFAULT;
+    GeneratorType.tp_new = PyType_GenericNew;
+    GeneratorType.tp_methods = GeneratorMethods;
+    
+    if (PyType_Ready(&GraphType) < 0 || PyType_Ready(&ArrayViewType) < 0 || PyType_Ready(&AssignerType) < 0 ||
+        PyType_Ready(&GeneratorType) < 0 || PyType_Ready(&NodeViewType) < 0 || PyType_Ready(&NodesType) < 0 ||
+        PyType_Ready(&EdgesType) < 0) {
+        return nullptr;
+    }
+    
+    PyObject* module = PyModule_Create(&NativeModule);
+    if (!module) return nullptr;
+    if (PyModule_AddObjectRef(module, "Graph", (PyObject*)&GraphType) < 0 ||
+        PyModule_AddObjectRef(module, "FrequencyAssigner", (PyObject*)&AssignerType) < 0 ||
+        PyModule_AddObjectRef(module, "NetworkGenerator", (PyObject*)&GeneratorType) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,22 @@
+"""
+Build the native extension backed by the C++ engines
+Run with: python setup.py build_ext --inplace
+"""
+
+from setuptools import setup, Extension
+
+native = Extension(
+    'graph_coloring_native',
+    sources=['graph_coloring_native.cpp'],
+    depends=['graph_coloring.cpp'],
+    extra_compile_args=['-std=c++17', '-O3', '-pthread'],
+    extra_link_args=['-pthread'],
+    language='c++',
+)
+
+setup(
+    name='graph_coloring_native',
+    version='1.0.0',
+    description='C++ graph coloring engines for network frequency assignment',
+    ext_modules=[native],
+)
@@ -0,0 +1,334 @@
+/*
+ * Microbenchmarks for the C++ graph coloring engines
+ *
+ * Build: g++ -std=c++17 -O3 -pthread tests/benchmark.cpp -o benchmark_cpp
+ * Run:   ./benchmark_cpp --sizes 1000,10000 --repetitions 7 --json bench.json
+ */
+
+#define GRAPH_COLORING_NO_MAIN
+#include "../graph_coloring.cpp"
+
+#include <functional>
+#include <sstream>
+
+struct BenchmarkOptions {
+    vector<int> sizes = {1000, 5000};
+    vector<string> families = {"geometric", "grid", "scalefree"};
+    int warmup = 1;
+    int repetitions = 5;
+    int threads = (int)max(1u, thread::hardware_concurrency());
+    uint64_t seed = 42;
+    double averageDegree = 12.0;
+    string filter;
+    string jsonPath;
+    bool counters = false;
+};
+
+struct BenchmarkResult {
+    string family;
+    string name;
+    int nodes = 0;
+    size_t edges = 0;
+    int colors = 0;
+    vector<double> samplesMs;
+    double medianMs = 0.0;
+    double p95Ms = 0.0;
+    double edgesPerSecond = 0.0;
+    size_t peakRSSBytes = 0;
+    string phasesJSON;
+};
+
+// Nearest-rank percentile of sorted samples
+double percentile(const vector<double>& sorted, double fraction) {
+    size_t rank = (size_t)ceil(fraction * sorted.size());
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+class BenchmarkRunner {
+private:
+    BenchmarkOptions options;
+    vector<BenchmarkResult> results;
+    vector<pair<string, MemoryReport>> memory;
+    
+    // `run` returns the number of colors used (0 for construction benchmarks)
+    template <typename Run>
+    void measure(const string& family, const string& name, int nodes, size_t edges, Run run) {
+        if (!options.filter.empty() && name.find(options.filter) == string::npos) return;
+        
+        BenchmarkResult result;
+        result.family = family;
+        result.name = name;
+        result.nodes = nodes;
+        result.edges = edges;
+        ProcessMemory::resetPeakRSS();
+        for (int i = 0; i < options.warmup; i++) run();
+        for (int i = 0; i < options.repetitions; i++) {
+            auto start = chrono::steady_clock::now();
+            result.colors = run();
+            auto end = chrono::steady_clock::now();
+            result.samplesMs.push_back(chrono::duration<double, milli>(end - start).count());
+        }
+        
+        result.peakRSSBytes = ProcessMemory::peakRSSBytes();
+        
+        vector<double> sorted = result.samplesMs;
+        sort(sorted.begin(), sorted.end());
+        result.medianMs = sorted.size() % 2 ? sorted[sorted.size() / 2]
+            : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+        result.p95Ms = percentile(sorted, 0.95);
+        result.edgesPerSecond = result.medianMs > 0 ? edges / (result.medianMs / 1000.0) : 0.0;
+        
+        printf("  %-24s %10.3f ms  p95 %10.3f ms  %12.0f edges/s  colors %d\n",
+               name.c_str(), result.medianMs, result.p95Ms, result.edgesPerSecond, result.colors);
+        results.push_back(result);
+    }
+    
+    // Attach the phase counters of the profiler's last run to the latest result
+    void attachPhases(const PhaseProfiler* profiler, const string& name) {
+        if (!profiler || results.empty() || results.back().name != name) return;
+        results.back().phasesJSON = profiler->toJSON();
+        profiler->print();
+    }
+    
+    static int colorCount(const vector<int>& colors) {
+        return colors.empty() ? 0 : *max_element(colors.begin(), colors.end()) + 1;
+    }
+    
+    void benchmarkFamily(const string& family, int size) {
+        // Geometric radius chosen for a fixed average degree, so sizes are comparable
+        double radius = sqrt(options.averageDegree * 1000.0 * 1000.0 / (M_PI * size));
+        int side = max(1, (int)sqrt((double)size));
+        
+        function<Graph()> buildGraph;
+        function<CompactGraph()> buildCompact;
+        if (family == "geometric") {
+            buildGraph = [&]() { return NetworkGenerator::randomGeometric(size, radius, 1000, 1000, options.seed); };
+            buildCompact = [&]() {
+                return NetworkGenerator::randomGeometricCompact(size, radius, 1000, 1000, options.seed, options.threads);
+            };
+        } else if (family == "grid") {
+            buildGraph = [&]() { return NetworkGenerator::cellularGrid(side, side); };
+            buildCompact = [&]() { return NetworkGenerator::cellularGrid(side, side).compact(); };
+        } else if (family == "scalefree") {
+            buildGraph = [&]() { return NetworkGenerator::scaleFree(size, 3, options.seed); };
+            buildCompact = [&]() { return NetworkGenerator::scaleFreeCompact(size, 3, options.seed, options.threads); };
+        } else {
+            cerr << "Error: Unknown family " << family << endl;
+            return;
+        }
+        
+        Graph graph = buildGraph();
+        graph.enableProfiling(options.counters);
+        CompactGraph compactGraph = graph.buildCompact();
+        int nodes = (int)graph.getNumNodes();
+        size_t edges = graph.getNumEdges();
+        printf("\n%s: %d nodes, %zu edges\n", family.c_str(), nodes, edges);
+        memory.push_back({family, graph.memoryUsage()});
+        memory.push_back({family, compactGraph.memoryUsage()});
+        memory[memory.size() - 2].second.print();
+        memory.back().second.print();
+        
+        measure(family, "build/graph", nodes, edges, [&]() { return (int)buildGraph().getNumNodes() * 0; });
+        measure(family, "build/compact", nodes, edges, [&]() { return (int)buildCompact().numVertices() * 0; });
+        measure(family, "build/snapshot", nodes, edges, [&]() { return graph.buildCompact().numVertices() * 0; });
+        
+        measure(family, "greedy", nodes, edges, [&]() { return graph.greedyColoring().first; });
+        attachPhases(graph.getProfiler(), "greedy");
+        measure(family, "welsh_powell", nodes, edges, [&]() { return graph.welshPowell().first; });
+        attachPhases(graph.getProfiler(), "welsh_powell");
+        measure(family, "dsatur", nodes, edges, [&]() { return graph.dsatur().first; });
+        attachPhases(graph.getProfiler(), "dsatur");
+        
+        // The snapshot engines take the profiler directly; it is reset so it holds the last run
+        PhaseProfiler compactProfiler;
+        PhaseProfiler* profiler = options.counters ? &compactProfiler : nullptr;
+        auto profiled = [profiler](auto run) {
+            if (profiler) profiler->reset();
+            return colorCount(run());
+        };
+        measure(family, "compact/greedy", nodes, edges,
+                [&]() { return profiled([&]() { return CompactColoring::greedy(compactGraph, nullptr, profiler); }); });
+        attachPhases(profiler, "compact/greedy");
+        measure(family, "compact/welsh_powell", nodes, edges, [&]() {
+            return profiled([&]() { return CompactColoring::welshPowell(compactGraph, nullptr, profiler); });
+        });
+        attachPhases(profiler, "compact/welsh_powell");
+        measure(family, "compact/dsatur", nodes, edges,
+                [&]() { return profiled([&]() { return CompactColoring::dsatur(compactGraph, nullptr, profiler); }); });
+        attachPhases(profiler, "compact/dsatur");
+        
+        DecompositionConfig decomposition;
+        decomposition.threads = options.threads;
+        measure(family, "components", nodes, edges, [&]() { return graph.colorByComponents(decomposition).first; });
+        
+        PartitionConfig partition;
+        partition.threads = options.threads;
+        measure(family, "partition", nodes, edges, [&]() { return graph.colorByPartition(partition).first; });
+        
+        measure(family, "periodic", nodes, edges, [&]() { return graph.periodicGridColoring().first; });
+        
+        // The same lattice with neighbors computed from (row, col), as --implicit-grid runs it
+        if (family == "grid") {
+            ImplicitGrid implicitGrid(side, side);
+            memory.push_back({family, implicitGrid.memoryUsage()});
+            memory.back().second.print();
+            measure(family, "implicit/greedy", nodes, edges,
+                    [&]() { return colorCount(CompactColoring::greedy(implicitGrid)); });
+            measure(family, "implicit/dsatur", nodes, edges,
+                    [&]() { return colorCount(CompactColoring::dsatur(implicitGrid)); });
+            measure(family, "implicit/periodic", nodes, edges,
+                    [&]() { return colorCount(PeriodicColoring::color(implicitGrid, options.threads)); });
+        }
+        
+        // Work-bounded rather than time-bounded so timings are comparable
+        HEAConfig hea;
+        hea.threads = options.threads;
+        hea.seed = options.seed;
+        hea.timeBudgetMs = 1e9;
+        hea.maxGenerations = 20;
+        hea.tabuIterations = 2000;
+        measure(family, "hea", nodes, edges, [&]() {
+            graph.dsatur();
+            return graph.hybridEvolutionary(hea).first;
+        });
+        
+        // TabuCol alone with the same seed and moves per round, as HEA's baseline
+        measure(family, "tabucol", nodes, edges, [&]() {
+            graph.dsatur();
+            return graph.tabuCol(hea).first;
+        });
+    }
+    
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options_) : options(options_) {}
+    
+    void run() {
+        for (const string& family : options.families) {
+            for (int size : options.sizes) benchmarkFamily(family, size);
+        }
+    }
+    
+    void exportToJSON(const string& filename) const {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Error: Cannot open file " << filename << endl;
+            return;
+        }
+        
+        file << "{\n";
+        file << "  \"warmup\": " << options.warmup << ",\n";
+        file << "  \"repetitions\": " << options.repetitions << ",\n";
+        file << "  \"threads\": " << options.threads << ",\n";
+        file << "  \"seed\": " << options.seed << ",\n";
+        file << "  \"memory\": [\n";
+        for (size_t i = 0; i < memory.size(); i++) {
+            file << "    {\"family\": \"" << memory[i].first << "\", \"nodes\": " << memory[i].second.vertices
+                 << ", \"report\": " << memory[i].second.toJSON() << "}" << (i + 1 < memory.size() ? ",\n" : "\n");
+        }
+        file << "  ],\n";
+        file << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& r = results[i];
+            file << "    {\"family\": \"" << r.family << "\", \"name\": \"" << r.name << "\""
+                 << ", \"nodes\": " << r.nodes << ", \"edges\": " << r.edges
+                 << ", \"colors\": " << r.colors
+                 << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+                 << ", \"edges_per_second\": " << r.edgesPerSecond
+                 << ", \"peak_rss_bytes\": " << r.peakRSSBytes << ", \"samples_ms\": [";
+            for (size_t j = 0; j < r.samplesMs.size(); j++) {
+                file << (j ? ", " : "") << r.samplesMs[j];
+            }
+            file << "]";
+            if (!r.phasesJSON.empty()) file << ", \"phases\": " << r.phasesJSON;
+            file << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n";
+        file << "}\n";
+        
+        cout << "\n✓ Exported to " << filename << endl;
+    }
+};
+
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+void printUsage() {
+    cout << "Usage: benchmark_cpp [options]\n"
+         << "  --sizes N[,N...]        node counts (default 1000,5000)\n"
+         << "  --families F[,F...]     geometric, grid, scalefree (default all)\n"
+         << "  --warmup N              untimed runs per benchmark (default 1)\n"
+         << "  --repetitions N         timed runs per benchmark (default 5)\n"
+         << "  --threads N             worker threads for parallel engines\n"
+         << "  --seed N                generator and HEA seed (default 42)\n"
+         << "  --degree D              target average degree for geometric graphs (default 12)\n"
+         << "  --filter TEXT           only benchmarks whose name contains TEXT\n"
+         << "  --json PATH             write machine-readable results\n"
+         << "  --counters              per-phase hardware counters for greedy, Welsh-Powell, DSATUR\n"
+         << "                          (Graph and compact engines)\n";
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (arg == "--counters") {
+            options.counters = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--sizes") {
+            options.sizes.clear();
+            for (const string& size : splitList(value)) options.sizes.push_back(stoi(size));
+        } else if (arg == "--families") {
+            options.families = splitList(value);
+        } else if (arg == "--warmup") {
+            options.warmup = stoi(value);
+        } else if (arg == "--repetitions") {
+            options.repetitions = max(1, stoi(value));
+        } else if (arg == "--threads") {
+            options.threads = max(1, stoi(value));
+        } else if (arg == "--seed") {
+            options.seed = stoull(value);
+        } else if (arg == "--degree") {
+            options.averageDegree = stod(value);
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+    
+    // The pool is sized on first use, so --threads must reach it before any benchmark runs
+    SchedulerConfig scheduler;
+    scheduler.threads = options.threads;
+    if (!TaskScheduler::configure(scheduler)) return 1;
+    
+    cout << "========================================" << endl;
+    cout << "GRAPH COLORING C++ MICROBENCHMARKS" << endl;
+    cout << "========================================" << endl;
+    
+    BenchmarkRunner runner(options);
+    runner.run();
+    if (!options.jsonPath.empty()) runner.exportToJSON(options.jsonPath);
+    
+    return 0;
+}
@@ -0,0 +1,497 @@
+/*
+ * Tests for the C++ graph coloring engines
+ *
+ * Build: g++ -std=c++17 -O2 -pthread tests/test_graph_coloring.cpp -o test_graph_coloring_cpp
+ * Run:   ./test_graph_coloring_cpp   (exit status 1 if any check fails)
+ */
+
+#define GRAPH_COLORING_NO_MAIN
+#include "../graph_coloring.cpp"
+
+#include <functional>
+
+static int failures = 0;
+
+// Unlike assert, stays active under -DNDEBUG and keeps running after a failure
+#define CHECK(condition)                                                                      \
+    do {                                                                                      \
+        if (!(condition)) {                                                                   \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);     \
+            failures++;                                                                       \
+        }                                                                                     \
+    } while (0)
+
+// Every vertex colored and no edge with both ends on the same color
+template <typename Topology>
+static bool legal(const Topology& graph, const vector<int>& colors) {
+    if ((int)colors.size() != graph.numVertices()) return false;
+    if (count(colors.begin(), colors.end(), -1) > 0) return false;
+    return CompactColoring::countConflicts(graph, colors) == 0;
+}
+
+static int colorCount(const vector<int>& colors) {
+    return (int)set<int>(colors.begin(), colors.end()).size();
+}
+
+static CompactGraph geometric(int n, double radius, uint64_t seed = 7) {
+    return NetworkGenerator::randomGeometricCompact(n, radius, 1000, 1000, seed, 2);
+}
+
+// Fresh directory under the system temp dir, removed by the caller
+static string scratchDirectory(const string& name) {
+    string path = (filesystem::temp_directory_path() / ("gc_test_" + to_string(getpid()) + "_" + name)).string();
+    filesystem::remove_all(path);
+    filesystem::create_directories(path);
+    return path;
+}
+
+// ---- Improvement engines ----
+
+void testHybridEvolutionaryIsLegal() {
+    CompactGraph graph = geometric(400, 90);
+    vector<int> seed = CompactColoring::dsatur(graph);
+    HEAConfig config;
+    config.threads = 2;
+    config.timeBudgetMs = 200;
+    config.maxGenerations = 20;
+    config.tabuIterations = 2000;
+    HybridEvolutionary<CompactGraph> engine(graph, config);
+    
+    vector<int> evolved = engine.run(seed);
+    CHECK(legal(graph, evolved));
+    CHECK(colorCount(evolved) <= colorCount(seed));
+    vector<int> tabu = engine.runTabuCol(seed);
+    CHECK(legal(graph, tabu));
+    CHECK(colorCount(tabu) <= colorCount(seed));
+    
+    // Seeds with uncolored vertices are completed before the search starts
+    vector<int> partial = seed;
+    for (size_t v = 0; v < partial.size(); v += 3) partial[v] = -1;
+    CHECK(legal(graph, engine.run(partial)));
+    CHECK(legal(graph, engine.run(vector<int>(graph.numVertices(), -1))));
+}
+
+void testImprovementStopsAtDeadline() {
+    CompactGraph graph = geometric(2000, 60);
+    RunControl control;
+    control.cancel();
+    RunSettings settings;
+    settings.control = &control;
+    vector<int> colors;
+    CHECK(runAlgorithm(graph, "hea", settings, colors));
+    CHECK((int)colors.size() == graph.numVertices());
+    CHECK(CompactColoring::countConflicts(graph, colors) == 0);
+}
+
+// ---- Minimum-churn recoloring ----
+
+void testMinChurnRepairsNewLinks() {
+    Graph graph = NetworkGenerator::randomGeometric(300, 120, 1000, 1000, 11);
+    graph.dsatur();
+    vector<int> ids = graph.compact().ids;
+    vector<int> colors = graph.getColors(graph.compact());
+    
+    // Link pairs of same-colored (so far unlinked) sites, as a topology change would
+    int added = 0;
+    for (int v = 0; v + 1 < (int)ids.size() && added < 10; v += 17) {
+        for (int u = v + 1; u < (int)ids.size(); u++) {
+            if (colors[u] == colors[v]) {
+                graph.addEdge(ids[v], ids[u]);
+                added++;
+                break;
+            }
+        }
+    }
+    CHECK(added > 0);
+    CHECK(graph.countConflicts() >= added);
+    
+    const CompactGraph& after = graph.compact();
+    vector<int> current = graph.getColors(after);
+    MinChurnConfig config;
+    config.timeBudgetMs = 200;
+    graph.minChurnRecolor(config);
+    CHECK(graph.countConflicts() == 0);
+    CHECK(graph.countUncolored() == 0);
+    int retuned = MinChurnRecoloring<CompactGraph>::changes(current, graph.getColors(after));
+    CHECK(retuned > 0 && retuned <= 4 * added);
+}
+
+// ---- Decomposition and partitioning ----
+
+void testDecompositionIsLegal() {
+    CompactGraph graph = geometric(1500, 35);
+    for (bool biconnected : {false, true}) {
+        DecompositionConfig config;
+        config.threads = 3;
+        config.biconnected = biconnected;
+        config.peelBelow = biconnected ? 3 : 0;
+        CHECK(legal(graph, DecomposedColoring::run(graph, config)));
+        
+        // A stopped run leaves vertices uncolored but never joins two equal colors
+        RunControl control;
+        control.cancel();
+        config.control = &control;
+        vector<int> colors = DecomposedColoring::run(graph, config);
+        CHECK((int)colors.size() == graph.numVertices());
+        CHECK(CompactColoring::countConflicts(graph, colors) == 0);
+    }
+}
+
+void testPartitionIsLegal() {
+    CompactGraph graph = geometric(3000, 40);
+    for (int shards : {1, 2, 5, 8}) {
+        PartitionConfig config;
+        config.shards = shards;
+        config.threads = 3;
+        CHECK(legal(graph, GraphPartitioner::run(graph, config)));
+    }
+}
+
+// The multi-machine workflow: shard files out, partial colorings back, boundary repair
+void testShardFilesRoundTrip() {
+    string directory = scratchDirectory("shards");
+    CompactGraph graph = geometric(2000, 45);
+    const int shards = 4;
+    vector<int> shardOf = GraphPartitioner::spatialPartition(graph, shards);
+    vector<vector<int>> members = GraphPartitioner::shardMembers(shardOf, shards);
+    
+    vector<int> colors;
+    for (int s = 0; s < shards; s++) {
+        string shardPath = directory + "/shard" + to_string(s) + ".gcsh";
+        string coloringPath = directory + "/shard" + to_string(s) + ".gcpc";
+        CompactGraph original = graph.induced(members[s]);
+        CHECK(GraphPartitioner::writeShard(shardPath, original));
+        CompactGraph shard;
+        CHECK(GraphPartitioner::readShard(shardPath, shard));
+        CHECK(shard.ids == original.ids && shard.offsets == original.offsets &&
+              shard.adjacency == original.adjacency && shard.positions == original.positions);
+        CHECK(GraphPartitioner::writePartialColoring(coloringPath, shard, CompactColoring::dsatur(shard)));
+        CHECK(GraphPartitioner::readPartialColoring(coloringPath, graph, colors));
+    }
+    GraphPartitioner::reconcileBoundary(graph, shardOf, colors);
+    CHECK(legal(graph, colors));
+    
+    // Truncated files and out-of-range neighbors are rejected, not read
+    string shardPath = directory + "/shard0.gcsh";
+    filesystem::resize_file(shardPath, filesystem::file_size(shardPath) - 4);
+    CompactGraph shard;
+    CHECK(!GraphPartitioner::readShard(shardPath, shard));
+    CompactGraph corrupt = graph.induced(members[0]);
+    corrupt.adjacency[0] = corrupt.numVertices() + 5;
+    CHECK(GraphPartitioner::writeShard(shardPath, corrupt));
+    CHECK(!GraphPartitioner::readShard(shardPath, shard));
+    filesystem::remove_all(directory);
+}
+
+// ---- Exports ----
+
+void testBinaryExportRoundTrip() {
+    string directory = scratchDirectory("gcvz");
+    CompactGraph graph = geometric(500, 70);
+    vector<int> colors = CompactColoring::dsatur(graph);
+    colors[3] = -1;
+    for (bool includeEdges : {true, false}) {
+        string path = directory + "/assignment.gcvz";
+        CHECK(AssignmentExport::write(path, graph, colors, includeEdges));
+        vector<int> ids, readColors;
+        CHECK(AssignmentExport::read(path, ids, readColors));
+        CHECK(ids == graph.ids);
+        CHECK(readColors == colors);
+    }
+    
+    string truncated = directory + "/truncated.gcvz";
+    CHECK(AssignmentExport::write(truncated, graph, colors, false));
+    filesystem::resize_file(truncated, AssignmentExport::HEADER_BYTES + 8);
+    vector<int> ids, readColors;
+    CHECK(!AssignmentExport::read(truncated, ids, readColors));
+    filesystem::remove_all(directory);
+}
+
+void testDeltaAlignsAndRoundTrips() {
+    string directory = scratchDirectory("delta");
+    CompactGraph graph = geometric(400, 80);
+    vector<int> previous = CompactColoring::dsatur(graph);
+    
+    // The same plan under other labels keeps every site once realigned
+    int numColors = colorCount(previous);
+    vector<int> relabeled = previous;
+    for (int& color : relabeled) color = (color + 1) % numColors;
+    CHECK(AssignmentDelta::alignColors(graph.ids, relabeled, graph.ids, previous) == graph.numVertices());
+    CHECK(relabeled == previous);
+    
+    // One retuned site, one new site and one removed site
+    vector<int> ids(graph.ids.begin() + 1, graph.ids.end()), colors(previous.begin() + 1, previous.end());
+    colors[0] = numColors;
+    ids.push_back(1000000);
+    colors.push_back(0);
+    string path = directory + "/delta.json";
+    CHECK(AssignmentDelta::write(path, ids, colors, graph.ids, previous));
+    ifstream file(path);
+    string text((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    CHECK(text.find("\"changed\": 1,") != string::npos);
+    CHECK(text.find("\"added\": 1,") != string::npos);
+    CHECK(text.find("\"removed\": 1,") != string::npos);
+    CHECK(text.find("{\"id\": " + to_string(ids[0]) + ", \"from\": " + to_string(previous[1]) +
+                    ", \"to\": " + to_string(numColors) + "}") != string::npos);
+    CHECK(text.find("{\"id\": 1000000, \"from\": -1, \"to\": 0}") != string::npos);
+    filesystem::remove_all(directory);
+}
+
+void testTilesCoverEverySite() {
+    string directory = scratchDirectory("tiles");
+    CompactGraph graph = geometric(1200, 60);
+    vector<int> colors = CompactColoring::dsatur(graph);
+    TileConfig config;
+    config.levels = 3;
+    config.threads = 2;
+    CHECK(TilePyramid::write(directory, graph, colors, config));
+    CHECK(filesystem::exists(directory + "/index.json"));
+    
+    // The leaf tiles partition the sites and keep their colors
+    map<int, int> colorOf;
+    for (const auto& entry : filesystem::directory_iterator(directory + "/" + to_string(config.levels))) {
+        vector<int> ids, tileColors;
+        CHECK(AssignmentExport::read(entry.path().string(), ids, tileColors));
+        for (size_t i = 0; i < ids.size(); i++) CHECK(colorOf.emplace(ids[i], tileColors[i]).second);
+    }
+    CHECK((int)colorOf.size() == graph.numVertices());
+    for (int v = 0; v < graph.numVertices(); v++) CHECK(colorOf[graph.ids[v]] == colors[v]);
+    filesystem::remove_all(directory);
+}
+
+// ---- Result cache ----
+
+void testResultCache() {
+    string directory = scratchDirectory("cache");
+    Graph first = NetworkGenerator::randomGeometric(500, 80, 1000, 1000, 5);
+    first.enableResultCache(directory);
+    first.dsatur();
+    CHECK(first.cacheStatus() == "miss");
+    
+    // Same topology in another graph: the stored coloring comes back
+    Graph second = NetworkGenerator::randomGeometric(500, 80, 1000, 1000, 5);
+    second.enableResultCache(directory);
+    second.dsatur();
+    CHECK(second.cacheStatus() == "hit");
+    CHECK(second.getColors(second.compact()) == first.getColors(second.compact()));
+    
+    // A different engine or topology misses
+    second.greedyColoring();
+    CHECK(second.cacheStatus() == "miss");
+    Graph other = NetworkGenerator::randomGeometric(500, 80, 1000, 1000, 6);
+    other.enableResultCache(directory);
+    other.dsatur();
+    CHECK(other.cacheStatus() == "miss");
+    
+    // Suspended runs leave the cache and its status alone
+    second.suspendResultCache(true);
+    second.welshPowell();
+    CHECK(second.cacheStatus() == "miss");
+    second.suspendResultCache(false);
+    
+    // Interrupted runs are partial and never stored
+    string stoppedDirectory = scratchDirectory("cache_stopped");
+    Graph stopped = NetworkGenerator::randomGeometric(500, 80, 1000, 1000, 5);
+    stopped.enableResultCache(stoppedDirectory);
+    RunControl control;
+    control.cancel();
+    stopped.setRunControl(&control);
+    stopped.dsatur();
+    stopped.setRunControl(nullptr);
+    CHECK(filesystem::is_empty(stoppedDirectory));
+    filesystem::remove_all(directory);
+    filesystem::remove_all(stoppedDirectory);
+}
+
+// ---- Coloring server ----
+
+#ifdef __linux__
+class TestClient {
+private:
+    int fd;
+    string buffer;
+    
+public:
+    explicit TestClient(const string& socketPath) : fd(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        // The server thread may still be binding
+        for (int attempt = 0; attempt < 200; attempt++) {
+            if (::connect(fd, (sockaddr*)&address, sizeof(address)) == 0) break;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        timeval timeout = {10, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    
+    ~TestClient() { ::close(fd); }
+    
+    void send(const string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            sent += (size_t)n;
+        }
+    }
+    
+    // One reply line; empty once the server closed the connection or timed out
+    string readLine() {
+        size_t end;
+        while ((end = buffer.find('\n')) == string::npos) {
+            char chunk[4096];
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return "";
+            buffer.append(chunk, (size_t)n);
+        }
+        string line = buffer.substr(0, end);
+        buffer.erase(0, end + 1);
+        return line;
+    }
+    
+    string request(const string& line) {
+        send(line + "\n");
+        return readLine();
+    }
+};
+
+void testColoringServer() {
+    string directory = scratchDirectory("server");
+    string socketPath = directory + "/server.sock";
+    CompactGraph graph = geometric(600, 70);
+    RunSettings settings;
+    settings.threads = 2;
+    settings.timeBudgetMs = 50;
+    ColoringServer server(graph, settings, 1);
+    thread serving([&]() { CHECK(server.serve(socketPath)); });
+    
+    {
+        // An idle connection must not hold the only worker
+        TestClient idle(socketPath);
+        TestClient client(socketPath);
+        CHECK(client.request("PING") == "OK");
+        
+        string reply = client.request("COLOR dsatur");
+        CHECK(reply.rfind("OK colors=", 0) == 0);
+        CHECK(reply.find(" conflicts=0 ") != string::npos);
+        CHECK(client.request("COLOR nonsense").rfind("ERR unknown algorithm", 0) == 0);
+        
+        // Link two same-colored sites, then repair with min_churn
+        string assignment = client.request("GET");
+        CHECK(assignment.rfind("OK ", 0) == 0);
+        unordered_map<int, int> colorOf;
+        istringstream pairs(assignment.substr(3));
+        string pair;
+        while (pairs >> pair) colorOf[stoi(pair.substr(0, pair.find(':')))] = stoi(pair.substr(pair.find(':') + 1));
+        CHECK((int)colorOf.size() == graph.numVertices());
+        int a = graph.ids[0], b = -1;
+        for (int v = 1; v < graph.numVertices() && b == -1; v++) {
+            if (colorOf[graph.ids[v]] == colorOf[a]) b = graph.ids[v];
+        }
+        reply = client.request("DELTA add " + to_string(a) + " " + to_string(b));
+        CHECK(reply.find(" conflicts=1 ") != string::npos);
+        reply = client.request("COLOR min_churn");
+        CHECK(reply.find(" conflicts=0 ") != string::npos);
+        
+        idle.send("PING\n");
+        CHECK(idle.readLine() == "OK");
+        
+        // An overlong line gets an error and the connection is closed
+        TestClient flood(socketPath);
+        flood.send(string(17 << 20, 'x'));
+        CHECK(flood.readLine() == "ERR request line too long");
+        CHECK(flood.readLine().empty());
+        CHECK(client.request("PING") == "OK");
+    }
+    server.stop();
+    serving.join();
+    filesystem::remove_all(directory);
+}
+#endif
+
+// ---- Implicit grids ----
+
+void testImplicitGridMatchesCellularGrid() {
+    for (auto [rows, cols] : vector<pair<int, int>>{{1, 1}, {1, 7}, {5, 1}, {6, 9}, {17, 13}}) {
+        ImplicitGrid grid(rows, cols);
+        CompactGraph stored = NetworkGenerator::cellularGrid(rows, cols).buildCompact();
+        CHECK(stored.numVertices() == grid.numVertices());
+        CHECK(grid.memoryUsage().edges == stored.numEdges());
+        for (int v = 0; v < stored.numVertices(); v++) {
+            int id = stored.ids[v];
+            vector<int> expected, actual;
+            stored.forEachNeighbor(v, [&](int u) { expected.push_back(stored.ids[u]); });
+            grid.forEachNeighbor(id, [&](int u) { actual.push_back(u); });
+            sort(expected.begin(), expected.end());
+            sort(actual.begin(), actual.end());
+            CHECK(expected == actual);
+            CHECK(grid.degree(id) == (int)actual.size());
+        }
+    }
+}
+
+void testImplicitGridEnginesAreLegal() {
+    ImplicitGrid grid(40, 55);
+    RunSettings settings;
+    settings.threads = 2;
+    settings.timeBudgetMs = 50;
+    for (const string& algorithm : IMPLICIT_GRID_ALGORITHMS) {
+        vector<int> colors;
+        CHECK(runAlgorithm(grid, algorithm, settings, colors));
+        CHECK(legal(grid, colors));
+        CHECK(colorCount(colors) <= 9);
+    }
+    vector<int> colors;
+    CHECK(!runAlgorithm(grid, "partition", settings, colors));
+}
+
+void testPeriodicGridColoring() {
+    // Larger than one 256-row chunk, so several scheduler tasks write rows
+    for (auto [rows, cols] : vector<pair<int, int>>{{1, 1}, {1, 2}, {2, 2}, {3, 1}, {700, 33}}) {
+        ImplicitGrid grid(rows, cols);
+        for (int threads : {1, 4}) {
+            vector<int> colors = PeriodicColoring::color(grid, threads);
+            CHECK(legal(grid, colors));
+            CHECK(colorCount(colors) == min(rows, 2) * min(cols, 2));
+        }
+    }
+}
+
+void testGridSpec() {
+    int rows = 0, cols = 0;
+    CHECK(NetworkGenerator::gridSpec("grid:3:4", rows, cols) && rows == 3 && cols == 4);
+    CHECK(!NetworkGenerator::gridSpec("grid:0:4", rows, cols));
+    CHECK(!NetworkGenerator::gridSpec("grid:3", rows, cols));
+    CHECK(!NetworkGenerator::gridSpec("grid:70000:70000", rows, cols));
+    CHECK(!NetworkGenerator::gridSpec("geometric:3:4", rows, cols));
+}
+
+int main() {
+    vector<pair<string, function<void()>>> tests = {
+        {"hybrid evolutionary is legal", testHybridEvolutionaryIsLegal},
+        {"improvement stops at deadline", testImprovementStopsAtDeadline},
+        {"min_churn repairs new links", testMinChurnRepairsNewLinks},
+        {"decomposition is legal", testDecompositionIsLegal},
+        {"partition is legal", testPartitionIsLegal},
+        {"shard files round-trip", testShardFilesRoundTrip},
+        {"binary export round-trips", testBinaryExportRoundTrip},
+        {"delta aligns and round-trips", testDeltaAlignsAndRoundTrips},
+        {"tiles cover every site", testTilesCoverEverySite},
+        {"result cache", testResultCache},
+#ifdef __linux__
+        {"coloring server", testColoringServer},
+#endif
+        {"implicit grid matches cellularGrid", testImplicitGridMatchesCellularGrid},
+        {"implicit grid engines are legal", testImplicitGridEnginesAreLegal},
+        {"periodic grid coloring", testPeriodicGridColoring},
+        {"grid spec", testGridSpec},
+    };
+    for (const auto& [name, test] : tests) {
+        int before = failures;
+        test();
+        printf("%s %s\n", failures == before ? "ok  " : "FAIL", name.c_str());
+    }
+    printf("%s\n", failures == 0 ? "All tests passed" : "Some tests failed");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+"""
+Tests for the native extension (graph_coloring_native)
+Build first with: python setup.py build_ext --inplace
+Run with: pytest tests/test_native.py -v
+"""
+
+import contextlib
+import gc
+import importlib
+import io
+import json
+import os
+import sys
+
+import pytest
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
+
+native = pytest.importorskip("graph_coloring_native")
+np = pytest.importorskip("numpy")
+
+Graph = native.Graph
+FrequencyAssigner = native.FrequencyAssigner
+NetworkGenerator = native.NetworkGenerator
+
+
+def triangle_with_tail():
+    graph = Graph(4)
+    for u, v in [(0, 1), (1, 2), (2, 0), (2, 3)]:
+        graph.add_edge(u, v)
+    return graph
+
+
+class TestNativeGraph:
+    """Graph construction and array views"""
+    
+    def test_counts(self):
+        """Test node and edge counts"""
+        graph = triangle_with_tail()
+        assert len(graph) == 4
+        assert graph.num_nodes == 4
+        assert graph.num_edges == 4
+    
+    def test_no_self_loops_or_duplicates(self):
+        """Test that self-loops and duplicate edges are ignored"""
+        graph = Graph(3)
+        graph.add_edge(0, 0)
+        graph.add_edge(0, 1)
+        graph.add_edge(1, 0)
+        assert graph.num_edges == 1
+    
+    def test_views_are_numpy(self):
+        """Test ids, degrees, colors and positions views"""
+        graph = triangle_with_tail()
+        graph.add_node(7, position=(3.0, 4.0))
+        assert graph.ids.dtype == np.int32
+        assert list(graph.ids) == [0, 1, 2, 3, 7]
+        assert list(graph.degrees) == [2, 2, 3, 1, 0]
+        assert list(graph.colors) == [-1] * 5
+        assert graph.positions.shape == (5, 2)
+        assert tuple(graph.positions[4]) == (3.0, 4.0)
+    
+    def test_views_are_zero_copy(self):
+        """Test that coloring updates an existing colors view in place"""
+        graph = triangle_with_tail()
+        colors = graph.colors
+        FrequencyAssigner(graph).dsatur()
+        assert sorted(set(colors.tolist())) == [0, 1, 2]
+        colors[3] = 9
+        assert graph.get_neighbor_colors(2) >= {9}
+    
+    def test_read_only_views(self):
+        """Test that ids and degrees cannot be written"""
+        graph = triangle_with_tail()
+        with pytest.raises(ValueError):
+            graph.degrees[0] = 5
+    
+    def test_topology_locked_while_viewed(self):
+        """Test that edits fail while a view is alive and succeed after"""
+        graph = triangle_with_tail()
+        colors = graph.colors
+        with pytest.raises(BufferError):
+            graph.add_edge(0, 3)
+        del colors
+        gc.collect()
+        graph.add_edge(0, 3)
+        assert graph.num_edges == 5
+    
+    def test_add_edge_unknown_node(self):
+        """Test that edges to missing nodes raise like the Python Graph"""
+        graph = triangle_with_tail()
+        with pytest.raises(ValueError):
+            graph.add_edge(0, 42)
+        assert graph.num_nodes == 4
+    
+    def test_nodes_mapping(self):
+        """Test the id -> node view mapping"""
+        graph = triangle_with_tail()
+        graph.add_node(7, position=(3.0, 4.0))
+        assert len(graph.nodes) == 5
+        assert sorted(graph.nodes.keys()) == [0, 1, 2, 3, 7]
+        assert 7 in graph.nodes and 5 not in graph.nodes
+        with pytest.raises(KeyError):
+            graph.nodes[5]
+        node = graph.nodes[2]
+        assert (node.id, node.degree, node.neighbors) == (2, 3, {0, 1, 3})
+        assert graph.nodes[7].position == (3.0, 4.0)
+        assert node.color is None
+        FrequencyAssigner(graph).dsatur()
+        assert node.color == graph.colors[2]
+        node.color = 9
+        assert graph.get_neighbor_colors(3) == {9}
+        node.color = None
+        assert graph.colors[2] == -1
+    
+    def test_nodes_of_spatially_ordered_graph(self):
+        """Test id lookups when the snapshot is not in id order"""
+        graph = NetworkGenerator.random_geometric(300, 120, seed=7)
+        FrequencyAssigner(graph).dsatur()
+        for node_id, node in graph.nodes.items():
+            assert graph.get_neighbor_colors(node_id) == {graph.nodes[u].color for u in node.neighbors}
+            assert node.color not in graph.get_neighbor_colors(node_id)
+    
+    def test_edges_view(self):
+        """Test that edges lists each link once"""
+        graph = triangle_with_tail()
+        assert len(graph.edges) == 4
+        assert sorted(tuple(sorted(edge)) for edge in graph.edges) == [(0, 1), (0, 2), (1, 2), (2, 3)]
+    
+    def test_basic_usage_example(self, tmp_path, monkeypatch):
+        """Test that examples/basic_usage.py runs unchanged on the native module"""
+        examples = os.path.join(os.path.dirname(__file__), '..', 'examples')
+        monkeypatch.syspath_prepend(os.path.abspath(examples))
+        monkeypatch.setitem(sys.modules, 'graph_coloring', native)
+        monkeypatch.delitem(sys.modules, 'basic_usage', raising=False)
+        monkeypatch.chdir(tmp_path)
+        basic_usage = importlib.import_module('basic_usage')
+        output = io.StringIO()
+        with contextlib.redirect_stdout(output):
+            basic_usage.main()
+        assert '⚠ Error' not in output.getvalue()
+        assert output.getvalue().count('Conflicts: 0') >= 3
+
+
+class TestNativeAssigner:
+    """FrequencyAssigner parity with graph_coloring.py"""
+    
+    @pytest.mark.parametrize("method", [
+        "greedy_coloring", "welsh_powell", "largest_first", "dsatur",
+        "color_by_components", "color_by_partition",
+    ])
+    def test_conflict_free(self, method):
+        """Test that every engine produces a legal coloring"""
+        graph = NetworkGenerator.random_geometric(300, 120, seed=7)
+        stats = getattr(FrequencyAssigner(graph), method)()
+        assert stats['conflicts'] == 0
+        assert stats['chromatic_number'] > 0
+    
+    def test_stats_keys(self):
+        """Test that stats match the Python implementation's keys"""
+        stats = FrequencyAssigner(triangle_with_tail()).dsatur()
+        assert set(stats) == {'algorithm', 'chromatic_number', 'conflicts', 'time_ms',
+                              'efficiency', 'nodes', 'edges'}
+        assert stats['algorithm'] == 'DSATUR'
+        assert stats['chromatic_number'] == 3
+    
+    def test_backtracking_exact(self):
+        """Test exact coloring and failure below the chromatic number"""
+        assigner = FrequencyAssigner(triangle_with_tail())
+        assert assigner.backtracking_exact()['chromatic_number'] == 3
+        assert 'error' in assigner.backtracking_exact(max_colors=2)
+    
+    def test_backtracking_exact_deep(self):
+        """Test that a long path does not exhaust the C stack"""
+        n = 500000
+        edges = np.stack([np.arange(n - 1), np.arange(1, n)], axis=1)
+        stats = FrequencyAssigner(Graph.from_edges(edges)).backtracking_exact(max_colors=2)
+        assert stats['chromatic_number'] == 2
+        assert stats['conflicts'] == 0
+    
+    def test_hybrid_evolutionary(self):
+        """Test HEA with a short budget"""
+        graph = NetworkGenerator.random_geometric(200, 150, seed=3)
+        assigner = FrequencyAssigner(graph)
+        dsatur_colors = assigner.dsatur()['chromatic_number']
+        stats = assigner.hybrid_evolutionary(time_budget_ms=100, seed=1, threads=1)
+        assert stats['conflicts'] == 0
+        assert stats['chromatic_number'] <= dsatur_colors
+    
+    def test_periodic_grid(self):
+        """Test the closed-form coloring of a hex grid"""
+        stats = FrequencyAssigner(NetworkGenerator.cellular_grid(10, 10)).periodic_grid_coloring()
+        assert stats['chromatic_number'] == 4
+        assert stats['conflicts'] == 0
+    
+    def test_smallest_available_color(self):
+        """Test finding smallest available color"""
+        assigner = FrequencyAssigner(Graph())
+        assert assigner.get_smallest_available_color({0, 1, 3}) == 2
+        assert assigner.get_smallest_available_color(set()) == 0
+    
+    def test_export_assignment(self, tmp_path):
+        """Test JSON export layout"""
+        assigner = FrequencyAssigner(triangle_with_tail())
+        assigner.dsatur()
+        path = tmp_path / "assignment.json"
+        assigner.export_assignment(str(path))
+        data = json.loads(path.read_text())
+        assert data['metadata']['algorithm'] == 'DSATUR'
+        assert len(data['assignments']) == 4
+        assert set(data['assignments'][0]) == {'node_id', 'frequency', 'position', 'degree'}
+
+
+class TestNativeGenerator:
+    """Generators"""
+    
+    def test_random_geometric_is_seeded(self):
+        """Test that the same seed gives the same network"""
+        first = NetworkGenerator.random_geometric(500, 80, seed=11)
+        second = NetworkGenerator.random_geometric(500, 80, seed=11)
+        assert first.num_edges == second.num_edges
+        assert np.array_equal(first.positions, second.positions)
+    
+    def test_cellular_grid_connectivity(self):
+        """Test square and hex grids"""
+        assert NetworkGenerator.cellular_grid(3, 3, connectivity='square').num_edges == 12
+        assert NetworkGenerator.cellular_grid(3, 3).num_edges == 20
+        with pytest.raises(ValueError):
+            NetworkGenerator.cellular_grid(3, 3, connectivity='triangle')
+    
+    def test_scale_free(self):
+        """Test scale-free generator size"""
+        graph = NetworkGenerator.scale_free(200, m=2)
+        assert graph.num_nodes == 200
+
+
+class TestNativeIngestion:
+    """Bulk construction from NumPy edge arrays"""
+    
+    @pytest.mark.parametrize("dtype", [np.int32, np.int64])
+    def test_from_edges(self, dtype):
+        """Test bulk build drops self-loops and duplicates"""
+        edges = np.array([[0, 1], [1, 2], [2, 0], [1, 0], [3, 3]], dtype=dtype)
+        graph = Graph.from_edges(edges)
+        assert graph.num_nodes == 4
+        assert graph.num_edges == 3
+        assert list(graph.degrees) == [2, 2, 2, 0]
+    
+    def test_from_edges_strided(self):
+        """Test non-contiguous views are read in place"""
+        edges = np.arange(20, dtype=np.int64).reshape(10, 2)
+        assert Graph.from_edges(edges[::2, ::-1]).num_edges == 5
+        assert Graph.from_edges(np.asfortranarray(edges)).num_edges == 10
+    
+    def test_from_edges_positions(self):
+        """Test positions and explicit node count"""
+        positions = np.array([[0.0, 0.0], [1.0, 0.0], [0.0, 1.0]])
+        graph = Graph.from_edges(np.array([[0, 1]]), positions=positions)
+        assert graph.num_nodes == 3
+        assert np.array_equal(graph.positions, positions)
+        assert Graph.from_edges(np.array([[0, 1]]), num_nodes=10).num_nodes == 10
+    
+    def test_from_edges_colors_and_edits(self):
+        """Test coloring and editing a bulk-built graph"""
+        graph = Graph.from_edges(np.array([[0, 1], [1, 2]], dtype=np.int32))
+        assert FrequencyAssigner(graph).dsatur()['conflicts'] == 0
+        graph.add_node(3)
+        graph.add_edge(2, 3)
+        assert graph.num_nodes == 4
+        assert graph.num_edges == 3
+    
+    @pytest.mark.parametrize("edges,error", [
+        (np.array([[0, 1, 2]]), ValueError),
+        (np.array([[0.0, 1.0]]), ValueError),
+        (np.array([[0, -1]]), ValueError),
+        ([[0, 1]], TypeError),
+    ])
+    def test_from_edges_rejects(self, edges, error):
+        """Test malformed edge arrays"""
+        with pytest.raises(error):
+            Graph.from_edges(edges)
+    
+    def test_from_edges_out_of_range(self):
+        """Test endpoints beyond num_nodes and mismatched positions"""
+        with pytest.raises(ValueError):
+            Graph.from_edges(np.array([[0, 5]]), num_nodes=3)
+        with pytest.raises(ValueError):
+            Graph.from_edges(np.array([[0, 1]]), positions=np.zeros((2, 2)), num_nodes=3)
@@ -1,5 +1,72 @@
 import React, { useState, useEffect } from 'react';
-import { Play, Pause, RotateCcw, Download, Settings, Info } from 'lucide-react';
+import { Play, Pause, RotateCcw, Download, Upload, Settings, Info } from 'lucide-react';
+
+// Binary assignment written by `graph_coloring --format binary` (GCVZ). Every
+// array starts on a 4-byte boundary, so the typed arrays below are views into
+// the file buffer rather than copies.
+export const readAssignmentBinary = (buffer) => {
+  const header = new DataView(buffer);
+  const magic = String.fromCharCode(...new Uint8Array(buffer, 0, 4));
+  if (buffer.byteLength < 48 || magic !== 'GCVZ' || header.getUint32(4, true) !== 1) {
+    throw new Error('Not a GCVZ v1 assignment file');
+  }
+
+  const flags = header.getUint32(8, true);
+  const n = header.getUint32(12, true);
+  const adjacencyLength = header.getUint32(24, true);
+  let offset = 48;
+  const positions = new Float32Array(buffer, offset, 2 * n);
+  offset += 8 * n;
+  const ids = new Int32Array(buffer, offset, n);
+  offset += 4 * n;
+  const colors = new Uint16Array(buffer, offset, n);
+  offset += 2 * (n + (n & 1));
+
+  let offsets = null;
+  let adjacency = null;
+  if (flags & 1) {
+    offsets = new Uint32Array(buffer, offset, n + 1);
+    offset += 4 * (n + 1);
+    adjacency = new Uint32Array(buffer, offset, adjacencyLength);
+  }
+
+  return {
+    n,
+    numColors: header.getUint32(16, true),
+    conflicts: header.getUint32(20, true),
+    bounds: new Float32Array(buffer, 32, 4),
+    positions,
+    ids,
+    colors,
+    offsets,
+    adjacency
+  };
+};
+
+// Tile pyramid written by `graph_coloring --tiles DIR`. Zoomed out, draw the
+// per-tile histograms from index.json; zoomed in, fetch only the leaf tiles
+// that intersect the view.
+export const loadTileIndex = async (baseUrl) => {
+  const response = await fetch(`${baseUrl}/index.json`);
+  return response.json();
+};
+
+export const visibleTiles = (index, level, view) => {
+  const [minX, minY, maxX, maxY] = index.bounds;
+  const side = 1 << level;
+  const tileWidth = (maxX - minX) / side;
+  const tileHeight = (maxY - minY) / side;
+  return index.tiles.filter(tile =>
+    tile.level === level &&
+    minX + (tile.x + 1) * tileWidth >= view.minX && minX + tile.x * tileWidth <= view.maxX &&
+    minY + (tile.y + 1) * tileHeight >= view.minY && minY + tile.y * tileHeight <= view.maxY
+  );
+};
+
+export const loadTile = async (baseUrl, tile) => {
+  const response = await fetch(`${baseUrl}/${tile.file}`);
+  return readAssignmentBinary(await response.arrayBuffer());
+};
 
 const FrequencyAssignmentViz = () => {
   const [nodes, setNodes] = useState([]);
@@ -205,6 +272,45 @@ const FrequencyAssignmentViz = () => {
     a.click();
   };
 
+  const loadBinary = async (event) => {
+    const file = event.target.files[0];
+    if (!file) return;
+    const assignment = readAssignmentBinary(await file.arrayBuffer());
+    const [minX, minY, maxX, maxY] = assignment.bounds;
+    const scale = Math.min(760 / Math.max(maxX - minX, 1e-6), 560 / Math.max(maxY - minY, 1e-6));
+
+    const newNodes = [];
+    for (let v = 0; v < assignment.n; v++) {
+      newNodes.push({
+        id: v,
+        siteId: assignment.ids[v],
+        x: 20 + (assignment.positions[2 * v] - minX) * scale,
+        y: 20 + (assignment.positions[2 * v + 1] - minY) * scale,
+        color: assignment.colors[v] === 0xFFFF ? null : assignment.colors[v],
+        degree: assignment.offsets ? assignment.offsets[v + 1] - assignment.offsets[v] : 0,
+        saturation: 0
+      });
+    }
+
+    const newEdges = [];
+    if (assignment.adjacency) {
+      for (let v = 0; v < assignment.n; v++) {
+        for (let i = assignment.offsets[v]; i < assignment.offsets[v + 1]; i++) {
+          if (assignment.adjacency[i] > v) newEdges.push({ from: v, to: assignment.adjacency[i] });
+        }
+      }
+    }
+
+    setNodes(newNodes);
+    setEdges(newEdges);
+    setStats({
+      colors: assignment.numColors,
+      conflicts: assignment.conflicts,
+      efficiency: ((assignment.n - assignment.numColors) / Math.max(assignment.n, 1) * 100).toFixed(1)
+    });
+    event.target.value = '';
+  };
+
   return (
     <div className="w-full h-screen bg-gradient-to-br from-slate-900 to-slate-800 text-white p-6">
       <div className="max-w-7xl mx-auto h-full flex flex-col">
@@ -389,6 +495,11 @@ const FrequencyAssignmentViz = () => {
                   <Download size={18} />
                   Export Results
                 </button>
+                <label className="col-span-2 bg-slate-700 hover:bg-slate-600 px-4 py-2 rounded font-medium flex items-center justify-center gap-2 cursor-pointer">
+                  <Upload size={18} />
+                  Load Binary
+                  <input type="file" accept=".gcvz" onChange={loadBinary} className="hidden" />
+                </label>
               </div>
             </div>
 